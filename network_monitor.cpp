@@ -2,6 +2,14 @@
 #include <cstring>
 #include <ctime>
 #include <cstdlib>
+#include <cstdio>
+#include <memory>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netinet/if_ether.h>
@@ -10,6 +18,7 @@
 #include <netinet/tcp.h>
 #include <netinet/udp.h>
 #include <arpa/inet.h>
+#include <net/if.h>
 #include <unistd.h>
 #include <linux/if_packet.h>
 
@@ -78,12 +87,23 @@ private:
     struct QueueNode {
         T value;
         QueueNode* following;
-        QueueNode(T v) : value(v), following(nullptr) {}
+        QueueNode() : value(), following(nullptr) {}
+        QueueNode(const T& v) : value(v), following(nullptr) {}
     };
     QueueNode* head;
     QueueNode* tail;
     int count;
 
+    void link(QueueNode* node) {
+        if (!head) {
+            head = tail = node;
+        } else {
+            tail->following = node;
+            tail = node;
+        }
+        count++;
+    }
+
 public:
     CustomQueue() : head(nullptr), tail(nullptr), count(0) {}
     
@@ -95,15 +115,14 @@ public:
         }
     }
 
-    void add(T item) {
-        QueueNode* node = new QueueNode(item);
-        if (!head) {
-            head = tail = node;
-        } else {
-            tail->following = node;
-            tail = node;
-        }
-        count++;
+    void add(const T& item) {
+        link(new QueueNode(item));
+    }
+
+    T& addBlank() {
+        QueueNode* node = new QueueNode();
+        link(node);
+        return node->value;
     }
 
     T remove() {
@@ -124,6 +143,27 @@ public:
 
     bool empty() { return head == nullptr; }
     int size() { return count; }
+
+    template <typename Visitor>
+    void visit(Visitor fn) const {
+        for (QueueNode* node = head; node; node = node->following) fn(node->value);
+    }
+
+    void swap(CustomQueue& other) {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(count, other.count);
+    }
+
+    void reset() {
+        while (head) {
+            QueueNode* temp = head;
+            head = head->following;
+            delete temp;
+        }
+        tail = nullptr;
+        count = 0;
+    }
 };
 
 enum LayerType { LAYER_ETH, LAYER_IP4, LAYER_IP6, LAYER_TCP_PROTO, LAYER_UDP_PROTO, LAYER_NONE };
@@ -158,21 +198,28 @@ struct ProtocolLayer {
 struct NetworkPacket {
     unsigned int identifier;
     time_t capturedAt;
-    unsigned char data[65536];
+    shared_ptr<const unsigned char> data;
     int length;
     string sourceIP;
     string destIP;
     int attemptsMade;
+    long long capturedUs;
+    long long rttUs;
+    int ifIndex;
 
-    NetworkPacket() : identifier(0), capturedAt(0), length(0), attemptsMade(0) {
-        memset(data, 0, sizeof(data));
-    }
+    NetworkPacket() : identifier(0), capturedAt(0), length(0), attemptsMade(0), capturedUs(0), rttUs(-1), ifIndex(0) {}
 
     NetworkPacket(unsigned int id, const unsigned char* buf, int len) 
-        : identifier(id), length(len), attemptsMade(0) {
-        capturedAt = time(nullptr);
+        : identifier(id), length(0), attemptsMade(0), rttUs(-1), ifIndex(0) {
+        timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        capturedAt = now.tv_sec;
+        capturedUs = now.tv_sec * 1000000LL + now.tv_nsec / 1000;
         if (buf && len > 0 && len <= 65536) {
-            memcpy(data, buf, len);
+            unsigned char* copy = new unsigned char[len];
+            memcpy(copy, buf, len);
+            data = shared_ptr<const unsigned char>(copy, default_delete<unsigned char[]>());
+            length = len;
         }
     }
 };
@@ -249,79 +296,1052 @@ public:
     int layerCount() { return layerStack.size(); }
 };
 
+const int RTT_BUCKETS = 100;
+const int FLOW_SLOTS = 4096;
+const int FLOW_PROBES = 8;
+const int PENDING_SEGMENTS = 16;
+const int TS_SLOTS = 16;
+const uint64_t FLOW_IDLE_US = 120000000ULL;
+
+struct RttHistogram {
+    uint32_t buckets[RTT_BUCKETS];
+    uint64_t samples;
+    uint64_t totalUs;
+    uint64_t minUs;
+    uint64_t maxUs;
+
+    RttHistogram() { reset(); }
+
+    void reset() {
+        memset(buckets, 0, sizeof(buckets));
+        samples = totalUs = minUs = maxUs = 0;
+    }
+
+    static int bucketFor(uint64_t us) {
+        if (us < 4) return (int)us;
+        int octave = 63 - __builtin_clzll(us);
+        int idx = (octave - 1) * 4 + (int)((us >> (octave - 2)) & 3);
+        return idx < RTT_BUCKETS ? idx : RTT_BUCKETS - 1;
+    }
+
+    static uint64_t bucketValue(int idx) {
+        if (idx < 4) return idx;
+        uint64_t width = 1ULL << (idx / 4 - 1);
+        return (uint64_t)(4 + idx % 4) * width + width / 2;
+    }
+
+    void record(uint64_t us) {
+        buckets[bucketFor(us)]++;
+        if (samples == 0 || us < minUs) minUs = us;
+        if (us > maxUs) maxUs = us;
+        samples++;
+        totalUs += us;
+    }
+
+    uint64_t percentile(double pct) const {
+        if (samples == 0) return 0;
+        uint64_t rank = (uint64_t)(pct * samples / 100.0 + 0.5);
+        if (rank < 1) rank = 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < RTT_BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                uint64_t value = bucketValue(i);
+                if (value < minUs) return minUs;
+                if (value > maxUs) return maxUs;
+                return value;
+            }
+        }
+        return maxUs;
+    }
+
+    uint64_t meanUs() const { return samples ? totalUs / samples : 0; }
+};
+
+struct TcpSegment {
+    bool ipv6;
+    unsigned char addr[2][16];
+    uint16_t port[2];
+    uint32_t seq;
+    uint32_t ack;
+    uint8_t flags;
+    uint32_t payload;
+    bool hasTs;
+    uint32_t tsVal;
+    uint32_t tsEcr;
+};
+
+struct FlowDirection {
+    uint32_t pendingEnd[PENDING_SEGMENTS];
+    uint64_t pendingAt[PENDING_SEGMENTS];
+    int pendingHead;
+    int pendingCount;
+    uint32_t tsVal[TS_SLOTS];
+    uint64_t tsAt[TS_SLOTS];
+    int tsNext;
+    uint32_t highestEnd;
+    bool seqKnown;
+    bool tsSeen;
+    bool local;
+    int64_t srttUs;
+    RttHistogram rtt;
+
+    void restart() {
+        pendingHead = pendingCount = tsNext = 0;
+        memset(tsAt, 0, sizeof(tsAt));
+        highestEnd = 0;
+        seqKnown = tsSeen = false;
+    }
+
+    void reset() {
+        restart();
+        local = false;
+        srttUs = -1;
+        rtt.reset();
+    }
+};
+
+struct FlowState {
+    bool used;
+    bool ipv6;
+    unsigned char addr[2][16];
+    uint16_t port[2];
+    uint64_t lastSeen;
+    uint64_t synAt;
+    uint64_t synAckAt;
+    uint32_t synSeq;
+    uint32_t synAckSeq;
+    int initiator;
+    int64_t handshakeUs;
+    FlowDirection dir[2];
+    RttHistogram rtt;
+
+    void reset() {
+        used = ipv6 = false;
+        lastSeen = synAt = synAckAt = 0;
+        synSeq = synAckSeq = 0;
+        initiator = -1;
+        handshakeUs = -1;
+        dir[0].reset();
+        dir[1].reset();
+        rtt.reset();
+    }
+};
+
+class LatencyTracker {
+private:
+    FlowState* flows;
+    RttHistogram aggregate;
+    RttHistogram handshakes;
+    uint64_t evictions;
+    uint64_t newestUs;
+
+    bool idle(const FlowState& flow) const {
+        return (int64_t)(newestUs - flow.lastSeen) > (int64_t)FLOW_IDLE_US;
+    }
+
+    static int64_t pathRtt(const FlowState& flow, int side, int64_t halfUs) {
+        const FlowDirection& self = flow.dir[side];
+        const FlowDirection& other = flow.dir[side ^ 1];
+        if (self.local != other.local) return self.local ? halfUs : -1;
+        return other.srttUs >= 0 ? halfUs + other.srttUs : -1;
+    }
+
+    static int64_t flowRtt(const FlowState& flow) {
+        for (int side = 0; side < 2; side++) {
+            if (flow.dir[side].srttUs < 0) continue;
+            int64_t rtt = pathRtt(flow, side, flow.dir[side].srttUs);
+            if (rtt >= 0) return rtt;
+        }
+        return -1;
+    }
+
+    static bool parseSegment(const unsigned char* buf, int len, TcpSegment& seg) {
+        if (len < 14) return false;
+        int offset = 14;
+        unsigned short ethType = ntohs(*(const unsigned short*)(buf + 12));
+        if (ethType == 0x8100 && len >= 18) {
+            ethType = ntohs(*(const unsigned short*)(buf + 16));
+            offset = 18;
+        }
+
+        int ipPayload;
+        memset(seg.addr, 0, sizeof(seg.addr));
+        if (ethType == 0x0800 && len >= offset + 20) {
+            const struct iphdr* ip = (const struct iphdr*)(buf + offset);
+            int hdrLen = ip->ihl * 4;
+            if (ip->protocol != IPPROTO_TCP || hdrLen < 20) return false;
+            if (ntohs(ip->frag_off) & 0x1FFF) return false;
+            seg.ipv6 = false;
+            memcpy(seg.addr[0], &ip->saddr, 4);
+            memcpy(seg.addr[1], &ip->daddr, 4);
+            ipPayload = ntohs(ip->tot_len) - hdrLen;
+            offset += hdrLen;
+        } else if (ethType == 0x86DD && len >= offset + 40) {
+            const struct ip6_hdr* ip6 = (const struct ip6_hdr*)(buf + offset);
+            if (ip6->ip6_nxt != IPPROTO_TCP) return false;
+            seg.ipv6 = true;
+            memcpy(seg.addr[0], &ip6->ip6_src, 16);
+            memcpy(seg.addr[1], &ip6->ip6_dst, 16);
+            ipPayload = ntohs(ip6->ip6_plen);
+            offset += 40;
+        } else {
+            return false;
+        }
+
+        if (len < offset + 20) return false;
+        const struct tcphdr* tcp = (const struct tcphdr*)(buf + offset);
+        int tcpLen = tcp->doff * 4;
+        if (tcpLen < 20 || ipPayload < tcpLen || len < offset + tcpLen) return false;
+
+        seg.port[0] = ntohs(tcp->source);
+        seg.port[1] = ntohs(tcp->dest);
+        seg.seq = ntohl(tcp->seq);
+        seg.ack = ntohl(tcp->ack_seq);
+        seg.flags = buf[offset + 13];
+        seg.payload = ipPayload - tcpLen;
+        seg.hasTs = false;
+
+        const unsigned char* opt = buf + offset + 20;
+        const unsigned char* optEnd = buf + offset + tcpLen;
+        while (opt < optEnd && *opt != TCPOPT_EOL) {
+            if (*opt == TCPOPT_NOP) {
+                opt++;
+                continue;
+            }
+            if (optEnd - opt < 2 || opt[1] < 2 || optEnd - opt < opt[1]) break;
+            if (opt[0] == TCPOPT_TIMESTAMP && opt[1] == TCPOLEN_TIMESTAMP) {
+                seg.hasTs = true;
+                seg.tsVal = ntohl(*(const uint32_t*)(opt + 2));
+                seg.tsEcr = ntohl(*(const uint32_t*)(opt + 6));
+            }
+            opt += opt[1];
+        }
+        return true;
+    }
+
+    FlowState* findFlow(const TcpSegment& seg, int& side, bool create) {
+        int order = memcmp(seg.addr[0], seg.addr[1], 16);
+        int first = (order < 0 || (order == 0 && seg.port[0] <= seg.port[1])) ? 0 : 1;
+
+        uint32_t hash = 2166136261u;
+        for (int s = 0; s < 2; s++) {
+            const unsigned char* a = seg.addr[first ^ s];
+            for (int i = 0; i < 16; i++) hash = (hash ^ a[i]) * 16777619u;
+            hash = (hash ^ (seg.port[first ^ s] & 0xFF)) * 16777619u;
+            hash = (hash ^ (seg.port[first ^ s] >> 8)) * 16777619u;
+        }
+
+        FlowState* victim = nullptr;
+        for (int p = 0; p < FLOW_PROBES; p++) {
+            FlowState* flow = &flows[(hash + p) % FLOW_SLOTS];
+            if (flow->used && idle(*flow)) flow->used = false;
+            if (!flow->used) {
+                if (!victim || victim->used) victim = flow;
+                continue;
+            }
+            if (flow->ipv6 == seg.ipv6 &&
+                flow->port[0] == seg.port[first] && flow->port[1] == seg.port[first ^ 1] &&
+                memcmp(flow->addr[0], seg.addr[first], 16) == 0 &&
+                memcmp(flow->addr[1], seg.addr[first ^ 1], 16) == 0) {
+                side = first;
+                return flow;
+            }
+            if (!victim || (victim->used && flow->lastSeen < victim->lastSeen)) victim = flow;
+        }
+
+        if (!create) return nullptr;
+        if (victim->used) evictions++;
+        victim->reset();
+        victim->used = true;
+        victim->ipv6 = seg.ipv6;
+        memcpy(victim->addr[0], seg.addr[first], 16);
+        memcpy(victim->addr[1], seg.addr[first ^ 1], 16);
+        victim->port[0] = seg.port[first];
+        victim->port[1] = seg.port[first ^ 1];
+        side = first;
+        return victim;
+    }
+
+    static void trackSent(FlowDirection& dir, uint32_t end, uint64_t nowUs) {
+        if (dir.seqKnown && (int32_t)(end - dir.highestEnd) <= 0) {
+            dir.pendingCount = 0;
+            return;
+        }
+        dir.highestEnd = end;
+        dir.seqKnown = true;
+        if (dir.pendingCount == PENDING_SEGMENTS) {
+            dir.pendingHead = (dir.pendingHead + 1) % PENDING_SEGMENTS;
+            dir.pendingCount--;
+        }
+        int slot = (dir.pendingHead + dir.pendingCount) % PENDING_SEGMENTS;
+        dir.pendingEnd[slot] = end;
+        dir.pendingAt[slot] = nowUs;
+        dir.pendingCount++;
+    }
+
+    static int64_t matchAck(FlowDirection& dir, uint32_t ack, uint64_t nowUs) {
+        int64_t sample = -1;
+        while (dir.pendingCount > 0 && (int32_t)(ack - dir.pendingEnd[dir.pendingHead]) >= 0) {
+            sample = nowUs - dir.pendingAt[dir.pendingHead];
+            dir.pendingHead = (dir.pendingHead + 1) % PENDING_SEGMENTS;
+            dir.pendingCount--;
+        }
+        return sample;
+    }
+
+    static void trackTsVal(FlowDirection& dir, uint32_t tsVal, uint64_t nowUs) {
+        int last = (dir.tsNext + TS_SLOTS - 1) % TS_SLOTS;
+        if (dir.tsAt[last] && dir.tsVal[last] == tsVal) return;
+        dir.tsVal[dir.tsNext] = tsVal;
+        dir.tsAt[dir.tsNext] = nowUs;
+        dir.tsNext = (dir.tsNext + 1) % TS_SLOTS;
+    }
+
+    static int64_t matchTsEcr(FlowDirection& dir, uint32_t tsEcr, uint64_t nowUs) {
+        for (int i = 0; i < TS_SLOTS; i++) {
+            if (dir.tsAt[i] && dir.tsVal[i] == tsEcr) {
+                int64_t sample = nowUs - dir.tsAt[i];
+                dir.tsAt[i] = 0;
+                return sample;
+            }
+        }
+        return -1;
+    }
+
+public:
+    LatencyTracker() : flows(new FlowState[FLOW_SLOTS]), evictions(0), newestUs(0) {
+        for (int i = 0; i < FLOW_SLOTS; i++) flows[i].reset();
+    }
+
+    ~LatencyTracker() { delete[] flows; }
+
+    LatencyTracker(const LatencyTracker&) = delete;
+    LatencyTracker& operator=(const LatencyTracker&) = delete;
+
+    int64_t observe(const unsigned char* buf, int len, uint64_t nowUs, bool outgoing) {
+        TcpSegment seg;
+        if (!parseSegment(buf, len, seg)) return -1;
+
+        if ((int64_t)(nowUs - newestUs) > 0) newestUs = nowUs;
+        int side;
+        FlowState* flow = findFlow(seg, side, true);
+        if ((int64_t)(nowUs - flow->lastSeen) > 0) flow->lastSeen = nowUs;
+        if (seg.flags & TH_RST) return flowRtt(*flow);
+
+        bool syn = seg.flags & TH_SYN;
+        bool fin = seg.flags & TH_FIN;
+        bool acked = seg.flags & TH_ACK;
+        FlowDirection& out = flow->dir[side];
+        FlowDirection& back = flow->dir[side ^ 1];
+
+        if (syn && !acked) {
+            if (flow->initiator != side || flow->synSeq != seg.seq) {
+                flow->dir[0].restart();
+                flow->dir[1].restart();
+                flow->initiator = side;
+                flow->synSeq = seg.seq;
+                flow->synAt = nowUs;
+                flow->synAckAt = 0;
+                flow->handshakeUs = -1;
+            }
+        } else if (syn && acked && flow->initiator == (side ^ 1) && !flow->synAckAt) {
+            flow->synAckAt = nowUs;
+            flow->synAckSeq = seg.seq;
+        } else if (!syn && acked && flow->initiator == side && flow->synAckAt &&
+                   flow->handshakeUs < 0 && seg.ack == flow->synAckSeq + 1) {
+            int64_t elapsed = (int64_t)(nowUs - flow->synAt);
+            if (elapsed >= 0) {
+                flow->handshakeUs = elapsed;
+                handshakes.record(elapsed);
+            }
+        }
+
+        if (outgoing) out.local = true;
+        if (seg.hasTs) out.tsSeen = true;
+        bool tsMode = out.tsSeen && back.tsSeen;
+
+        uint32_t consumed = seg.payload + (syn ? 1 : 0) + (fin ? 1 : 0);
+        if (consumed > 0) {
+            trackSent(out, seg.seq + consumed, nowUs);
+            if (seg.hasTs) trackTsVal(out, seg.tsVal, nowUs);
+        }
+
+        int64_t sample = -1;
+        if (acked) {
+            int64_t seqSample = matchAck(back, seg.ack, nowUs);
+            if (!tsMode) sample = seqSample;
+            else if (seg.hasTs) sample = matchTsEcr(back, seg.tsEcr, nowUs);
+        }
+
+        if (sample >= 0) {
+            back.rtt.record(sample);
+            back.srttUs = back.srttUs < 0 ? sample : (7 * back.srttUs + sample) / 8;
+            int64_t rtt = pathRtt(*flow, side ^ 1, sample);
+            if (rtt >= 0) {
+                flow->rtt.record(rtt);
+                aggregate.record(rtt);
+            }
+        }
+        return flowRtt(*flow);
+    }
+
+    int64_t lookup(const unsigned char* buf, int len) {
+        TcpSegment seg;
+        if (!parseSegment(buf, len, seg)) return -1;
+        int side;
+        FlowState* flow = findFlow(seg, side, false);
+        return flow ? flowRtt(*flow) : -1;
+    }
+
+    int activeFlows() const {
+        int count = 0;
+        for (int i = 0; i < FLOW_SLOTS; i++) {
+            if (flows[i].used && !idle(flows[i])) count++;
+        }
+        return count;
+    }
+
+    uint64_t sampleCount() const { return aggregate.samples; }
+
+    static void printDistribution(const char* label, const RttHistogram& hist) {
+        cout << "  " << label << "\n";
+        if (hist.samples == 0) {
+            cout << "    No samples recorded\n";
+            return;
+        }
+        cout << "    Samples: " << hist.samples
+             << " | Min: " << hist.minUs / 1000.0 << "ms"
+             << " | Mean: " << hist.meanUs() / 1000.0 << "ms"
+             << " | Max: " << hist.maxUs / 1000.0 << "ms\n";
+        cout << "    p50: " << hist.percentile(50) / 1000.0 << "ms"
+             << " | p90: " << hist.percentile(90) / 1000.0 << "ms"
+             << " | p99: " << hist.percentile(99) / 1000.0 << "ms\n";
+    }
+
+    void report(int topFlows) {
+        printDistribution("Aggregate RTT (data/ACK and timestamp echo):", aggregate);
+        cout << "\n";
+        printDistribution("TCP Handshake (SYN → SYN/ACK → ACK):", handshakes);
+        cout << "\n  Tracked flows: " << activeFlows() << "/" << FLOW_SLOTS
+             << " | Evictions: " << evictions << "\n";
+
+        bool* shown = new bool[FLOW_SLOTS]();
+        for (int n = 0; n < topFlows; n++) {
+            int best = -1;
+            for (int i = 0; i < FLOW_SLOTS; i++) {
+                if (!flows[i].used || idle(flows[i]) || shown[i] || flows[i].rtt.samples == 0) continue;
+                if (best < 0 || flows[i].rtt.samples > flows[best].rtt.samples) best = i;
+            }
+            if (best < 0) break;
+            shown[best] = true;
+            if (n == 0) cout << "\n  Busiest flows:\n";
+
+            const FlowState& flow = flows[best];
+            char a[INET6_ADDRSTRLEN], b[INET6_ADDRSTRLEN];
+            inet_ntop(flow.ipv6 ? AF_INET6 : AF_INET, flow.addr[0], a, sizeof(a));
+            inet_ntop(flow.ipv6 ? AF_INET6 : AF_INET, flow.addr[1], b, sizeof(b));
+            cout << "    " << a << ":" << flow.port[0] << " ↔ " << b << ":" << flow.port[1] << "\n";
+            cout << "      Samples: " << flow.rtt.samples
+                 << " | RTT: " << flowRtt(flow) / 1000.0 << "ms"
+                 << " | p50: " << flow.rtt.percentile(50) / 1000.0 << "ms"
+                 << " | p99: " << flow.rtt.percentile(99) / 1000.0 << "ms";
+            if (flow.handshakeUs >= 0) cout << " | Handshake: " << flow.handshakeUs / 1000.0 << "ms";
+            cout << "\n";
+            for (int side = 0; side < 2; side++) {
+                const FlowDirection& half = flow.dir[side];
+                cout << (side == 0 ? "      Leg to " : " | Leg to ") << (side == 0 ? b : a) << ": ";
+                if (half.srttUs >= 0) cout << half.srttUs / 1000.0 << "ms";
+                else cout << "n/a";
+                if (half.local) cout << " (sent here)";
+            }
+            cout << "\n";
+        }
+        delete[] shown;
+    }
+};
+
+const char CHECKPOINT_MAGIC[8] = { 'N', 'M', 'O', 'N', 'C', 'K', 'P', 'T' };
+const uint32_t CHECKPOINT_VERSION = 3;
+const char* const CHECKPOINT_PATH = "network_monitor.ckpt";
+const int CHECKPOINT_INTERVAL = 10;
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t nextID;
+    uint64_t queueCounts[3];
+    uint64_t fileSize;
+};
+
+struct CheckpointRecord {
+    uint32_t identifier;
+    int32_t length;
+    int64_t capturedAt;
+    int32_t attemptsMade;
+    int32_t ifIndex;
+    int64_t capturedUs;
+    int64_t rttUs;
+    char sourceIP[48];
+    char destIP[48];
+};
+
+struct CheckpointMapping {
+    void* base;
+    size_t size;
+
+    CheckpointMapping(void* b, size_t len) : base(b), size(len) {}
+    ~CheckpointMapping() { munmap(base, size); }
+};
+
+class CheckpointStore {
+private:
+    static uint64_t padded(uint64_t len) { return (len + 7) & ~(uint64_t)7; }
+
+    static bool writeQueue(FILE* out, const CustomQueue<NetworkPacket>& queue, uint64_t& written) {
+        static const unsigned char zeros[8] = { 0 };
+        bool ok = true;
+
+        queue.visit([&](const NetworkPacket& pkt) {
+            if (!ok) return;
+            CheckpointRecord rec;
+            memset(&rec, 0, sizeof(rec));
+            rec.identifier = pkt.identifier;
+            rec.length = pkt.length;
+            rec.capturedAt = pkt.capturedAt;
+            rec.attemptsMade = pkt.attemptsMade;
+            rec.ifIndex = pkt.ifIndex;
+            rec.capturedUs = pkt.capturedUs;
+            rec.rttUs = pkt.rttUs;
+            strncpy(rec.sourceIP, pkt.sourceIP.c_str(), sizeof(rec.sourceIP) - 1);
+            strncpy(rec.destIP, pkt.destIP.c_str(), sizeof(rec.destIP) - 1);
+
+            size_t pad = padded(pkt.length) - pkt.length;
+            ok = fwrite(&rec, sizeof(rec), 1, out) == 1 &&
+                 fwrite(pkt.data.get(), 1, pkt.length, out) == (size_t)pkt.length &&
+                 fwrite(zeros, 1, pad, out) == pad;
+            written += sizeof(rec) + pkt.length + pad;
+        });
+        return ok;
+    }
+
+    static bool readQueues(const shared_ptr<CheckpointMapping>& mapping, const CheckpointHeader& header,
+                           CustomQueue<NetworkPacket>* queues) {
+        const unsigned char* bytes = (const unsigned char*)mapping->base;
+        uint64_t offset = sizeof(CheckpointHeader);
+
+        for (int q = 0; q < 3; q++) {
+            for (uint64_t i = 0; i < header.queueCounts[q]; i++) {
+                if (header.fileSize - offset < sizeof(CheckpointRecord)) return false;
+                CheckpointRecord rec;
+                memcpy(&rec, bytes + offset, sizeof(rec));
+                offset += sizeof(rec);
+
+                if (rec.length < 0 || rec.length > 65536) return false;
+                if (header.fileSize - offset < padded(rec.length)) return false;
+
+                rec.sourceIP[sizeof(rec.sourceIP) - 1] = '\0';
+                rec.destIP[sizeof(rec.destIP) - 1] = '\0';
+                NetworkPacket& pkt = queues[q].addBlank();
+                pkt.identifier = rec.identifier;
+                pkt.data = shared_ptr<const unsigned char>(mapping, bytes + offset);
+                pkt.length = rec.length;
+                pkt.capturedAt = rec.capturedAt;
+                pkt.attemptsMade = rec.attemptsMade;
+                pkt.ifIndex = rec.ifIndex;
+                pkt.capturedUs = rec.capturedUs;
+                pkt.rttUs = rec.rttUs;
+                pkt.sourceIP = rec.sourceIP;
+                pkt.destIP = rec.destIP;
+                offset += padded(rec.length);
+            }
+        }
+        return offset == header.fileSize;
+    }
+
+public:
+    static bool save(const char* path, unsigned int nextID, CustomQueue<NetworkPacket>** queues) {
+        string tmpPath = string(path) + ".tmp";
+        FILE* out = fopen(tmpPath.c_str(), "wb");
+        if (!out) return false;
+        setvbuf(out, nullptr, _IOFBF, 1 << 20);
+
+        CheckpointHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+        header.version = CHECKPOINT_VERSION;
+        header.recordSize = sizeof(CheckpointRecord);
+        header.nextID = nextID;
+
+        uint64_t written = sizeof(header);
+        bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+        for (int q = 0; q < 3; q++) {
+            header.queueCounts[q] = queues[q]->size();
+            ok = writeQueue(out, *queues[q], written) && ok;
+        }
+        header.fileSize = written;
+
+        ok = ok && fseek(out, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, out) == 1;
+        ok = fflush(out) == 0 && ok;
+        ok = ok && fsync(fileno(out)) == 0;
+        ok = fclose(out) == 0 && ok;
+
+        if (!ok || rename(tmpPath.c_str(), path) != 0) {
+            unlink(tmpPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    static bool load(const char* path, unsigned int& nextID, CustomQueue<NetworkPacket>** queues) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (uint64_t)info.st_size < sizeof(CheckpointHeader)) {
+            close(fd);
+            return false;
+        }
+
+        size_t mapped = info.st_size;
+        void* base = mmap(nullptr, mapped, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) return false;
+        shared_ptr<CheckpointMapping> mapping(new CheckpointMapping(base, mapped));
+
+        CheckpointHeader header;
+        memcpy(&header, base, sizeof(header));
+        if (memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != CHECKPOINT_VERSION ||
+            header.recordSize != sizeof(CheckpointRecord) ||
+            header.fileSize != mapped) {
+            return false;
+        }
+
+        CustomQueue<NetworkPacket> loaded[3];
+        if (!readQueues(mapping, header, loaded)) return false;
+
+        for (int q = 0; q < 3; q++) queues[q]->swap(loaded[q]);
+        nextID = header.nextID;
+        return true;
+    }
+};
+
+const int MAX_INTERFACES = 32;
+const int CAPTURE_BATCH = 64;
+const int DEDUP_SLOTS = 8192;
+const int64_t DEDUP_WINDOW_US = 50000;
+const int DEDUP_HASH_BYTES = 128;
+
+struct CaptureInterface {
+    char name[IF_NAMESIZE];
+    int index;
+    int fd;
+    uint64_t packets;
+    uint64_t bytes;
+    uint64_t duplicates;
+    uint64_t drops;
+    uint64_t sessionPackets;
+    uint64_t sessionBytes;
+};
+
+class FrameDeduplicator {
+private:
+    struct SeenFrame {
+        uint64_t hash;
+        int64_t seenUs;
+        int ifIndex;
+        bool outgoing;
+    };
+    SeenFrame* table;
+
+public:
+    FrameDeduplicator() : table(new SeenFrame[DEDUP_SLOTS]()) {}
+    ~FrameDeduplicator() { delete[] table; }
+
+    FrameDeduplicator(const FrameDeduplicator&) = delete;
+    FrameDeduplicator& operator=(const FrameDeduplicator&) = delete;
+
+    bool duplicate(const unsigned char* buf, int len, int ifIndex, int pktType, int64_t nowUs) {
+        uint64_t hash = (14695981039346656037ULL ^ (uint64_t)len) * 1099511628211ULL;
+        int hashed = len < DEDUP_HASH_BYTES ? len : DEDUP_HASH_BYTES;
+        for (int i = 0; i < hashed; i++) hash = (hash ^ buf[i]) * 1099511628211ULL;
+
+        bool outgoing = pktType == PACKET_OUTGOING;
+        SeenFrame& seen = table[hash % DEDUP_SLOTS];
+        int64_t age = nowUs - seen.seenUs;
+        bool repeat = seen.seenUs != 0 && seen.hash == hash &&
+                      age <= DEDUP_WINDOW_US && age >= -DEDUP_WINDOW_US &&
+                      (seen.ifIndex != ifIndex || seen.outgoing != outgoing);
+        if (repeat) return true;
+
+        seen.hash = hash;
+        seen.seenUs = nowUs;
+        seen.ifIndex = ifIndex;
+        seen.outgoing = outgoing;
+        return false;
+    }
+};
+
 class PacketMonitor {
 private:
     CustomQueue<NetworkPacket> mainQueue;
     CustomQueue<NetworkPacket> matchedQueue;
     CustomQueue<NetworkPacket> retryQueue;
     LayerParser parser;
+    LatencyTracker latency;
     unsigned int nextID;
-    int socketFD;
+    CaptureInterface interfaces[MAX_INTERFACES];
+    int interfaceCount;
+    int epollFD;
+    bool dedupEnabled;
+    FrameDeduplicator dedup;
     bool active;
+    pid_t snapshotPID;
+    time_t lastSnapshot;
+    double lastCaptureSeconds;
+
+    bool addInterface(const char* name, int index, const CaptureInterface* previous, int previousCount) {
+        for (int i = 0; i < interfaceCount; i++) {
+            if (interfaces[i].index == index) {
+                cout << "\n[WARNING] Interface " << name << " listed more than once, capturing it once\n";
+                return true;
+            }
+        }
+        if (interfaceCount == MAX_INTERFACES) return false;
+
+        CaptureInterface& iface = interfaces[interfaceCount++];
+        memset(&iface, 0, sizeof(iface));
+        for (int i = 0; i < previousCount; i++) {
+            if (previous[i].index == index) iface = previous[i];
+        }
+        strncpy(iface.name, name, sizeof(iface.name) - 1);
+        iface.index = index;
+        iface.fd = -1;
+        return true;
+    }
+
+    void closeSockets() {
+        for (int i = 0; i < interfaceCount; i++) {
+            if (interfaces[i].fd >= 0) close(interfaces[i].fd);
+            interfaces[i].fd = -1;
+        }
+        if (epollFD >= 0) close(epollFD);
+        epollFD = -1;
+    }
+
+    void collectDrops(CaptureInterface& iface) {
+        if (iface.fd < 0) return;
+        tpacket_stats kernel;
+        socklen_t size = sizeof(kernel);
+        if (getsockopt(iface.fd, SOL_PACKET, PACKET_STATISTICS, &kernel, &size) == 0) {
+            iface.drops += kernel.tp_drops;
+        }
+    }
+
+    string interfaceName(int index) {
+        for (int i = 0; i < interfaceCount; i++) {
+            if (interfaces[i].index == index) return interfaces[i].name;
+        }
+        char name[IF_NAMESIZE];
+        if (index > 0 && if_indextoname(index, name)) return name;
+        return "-";
+    }
+
+    void receiveFrame(CaptureInterface& iface, const sockaddr_ll& from, const unsigned char* buffer, int received, msghdr& msg) {
+        timespec stamp;
+        clock_gettime(CLOCK_REALTIME, &stamp);
+        for (cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPNS) {
+                memcpy(&stamp, CMSG_DATA(c), sizeof(stamp));
+            }
+        }
+        long long stampUs = stamp.tv_sec * 1000000LL + stamp.tv_nsec / 1000;
+
+        iface.packets++;
+        iface.bytes += received;
+        iface.sessionPackets++;
+        iface.sessionBytes += received;
+        bool repeat = dedup.duplicate(buffer, received, from.sll_ifindex, from.sll_pkttype, stampUs);
+        if (repeat && dedupEnabled) {
+            iface.duplicates++;
+            return;
+        }
+
+        NetworkPacket pkt(++nextID, buffer, received);
+        pkt.capturedAt = stamp.tv_sec;
+        pkt.capturedUs = stampUs;
+        pkt.ifIndex = from.sll_ifindex;
+        if (repeat) {
+            pkt.rttUs = latency.lookup(buffer, received);
+        } else {
+            pkt.rttUs = latency.observe(buffer, received, pkt.capturedUs, from.sll_pkttype == PACKET_OUTGOING);
+        }
+
+        if (received >= 34) {
+            struct iphdr* ip = (struct iphdr*)(buffer + 14);
+            if (ip->version == 4) {
+                char src[INET_ADDRSTRLEN], dst[INET_ADDRSTRLEN];
+                inet_ntop(AF_INET, &ip->saddr, src, INET_ADDRSTRLEN);
+                inet_ntop(AF_INET, &ip->daddr, dst, INET_ADDRSTRLEN);
+                pkt.sourceIP = src;
+                pkt.destIP = dst;
+            }
+        }
+
+        mainQueue.add(pkt);
+        cout << "[PKT #" << pkt.identifier << "] "
+             << received << "B | "
+             << iface.name << " | "
+             << pkt.sourceIP << " → " << pkt.destIP << "\n";
+    }
+
+    void showInterfaceStats(bool session) {
+        cout << (session ? "  Interface Summary (this session):\n" : "  Per-Interface Capture (all sessions):\n");
+        for (int i = 0; i < interfaceCount; i++) {
+            const CaptureInterface& iface = interfaces[i];
+            uint64_t packets = session ? iface.sessionPackets : iface.packets;
+            uint64_t bytes = session ? iface.sessionBytes : iface.bytes;
+            cout << "    " << iface.name << " (ifindex " << iface.index << ")\n";
+            cout << "      Packets: " << packets << " | Bytes: " << bytes;
+            if (session && lastCaptureSeconds > 0) {
+                cout << " | Rate: " << packets / lastCaptureSeconds << " pkt/s, "
+                     << bytes * 8 / lastCaptureSeconds / 1e6 << " Mbit/s";
+            }
+            cout << "\n      Duplicates suppressed: " << iface.duplicates
+                 << " | Kernel drops: " << iface.drops << "\n";
+        }
+        cout << "\n";
+    }
+
+    bool writeCheckpoint() {
+        CustomQueue<NetworkPacket>* queues[3] = { &mainQueue, &matchedQueue, &retryQueue };
+        return CheckpointStore::save(CHECKPOINT_PATH, nextID, queues);
+    }
+
+    void startBackgroundSnapshot() {
+        if (snapshotPID > 0) return;
+        pid_t pid = fork();
+        if (pid == 0) {
+            _exit(writeCheckpoint() ? 0 : 1);
+        }
+        if (pid > 0) snapshotPID = pid;
+    }
+
+    void reapBackgroundSnapshot(bool block) {
+        if (snapshotPID <= 0) return;
+        int status = 0;
+        pid_t done = waitpid(snapshotPID, &status, block ? 0 : WNOHANG);
+        if (done == 0) return;
+        if (done < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            cout << "[WARNING] Background checkpoint failed\n";
+        }
+        snapshotPID = -1;
+    }
+
+    bool configureFrom(const string& spec, const CaptureInterface* previous, int previousCount) {
+        if (spec == "all") {
+            struct if_nameindex* list = if_nameindex();
+            if (!list) {
+                cout << "\n[ERROR] Unable to enumerate network interfaces\n";
+                return false;
+            }
+            int available = 0;
+            for (struct if_nameindex* it = list; it->if_index != 0; it++) {
+                addInterface(it->if_name, it->if_index, previous, previousCount);
+                available++;
+            }
+            if_freenameindex(list);
+            if (available > interfaceCount) {
+                cout << "\n[WARNING] Found " << available << " interfaces, capturing only the first "
+                     << interfaceCount << "\n";
+                cout << "Name the interfaces to capture to choose which ones are used\n";
+            }
+            return interfaceCount > 0;
+        }
+
+        size_t pos = 0;
+        while (pos < spec.size()) {
+            size_t comma = spec.find(',', pos);
+            if (comma == string::npos) comma = spec.size();
+            string name = spec.substr(pos, comma - pos);
+            pos = comma + 1;
+            if (name.empty()) continue;
+
+            unsigned int index = if_nametoindex(name.c_str());
+            if (index == 0) {
+                cout << "\n[ERROR] Unknown network interface: " << name << "\n";
+                return false;
+            }
+            if (!addInterface(name.c_str(), index, previous, previousCount)) {
+                cout << "\n[ERROR] At most " << MAX_INTERFACES << " interfaces can be captured\n";
+                return false;
+            }
+        }
+        return interfaceCount > 0;
+    }
 
 public:
-    PacketMonitor() : nextID(0), socketFD(-1), active(false) {
+    PacketMonitor() : nextID(0), interfaceCount(0), epollFD(-1), dedupEnabled(false), active(false),
+                      snapshotPID(-1), lastSnapshot(0), lastCaptureSeconds(0) {
         srand(time(nullptr));
     }
 
     ~PacketMonitor() {
-        if (socketFD >= 0) close(socketFD);
+        reapBackgroundSnapshot(true);
+        closeSockets();
     }
 
-    bool setupSocket() {
-        if (socketFD >= 0) return true;
-        
-        socketFD = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
-        if (socketFD < 0) {
-            cout << "\n[ERROR] Socket initialization failed\n";
-            cout << "Reason: Insufficient permissions for raw socket access\n";
+    bool configureInterfaces(const string& spec, bool dedup) {
+        closeSockets();
+        CaptureInterface previous[MAX_INTERFACES];
+        int previousCount = interfaceCount;
+        bool previousDedup = dedupEnabled;
+        memcpy(previous, interfaces, sizeof(previous));
+        interfaceCount = 0;
+        dedupEnabled = dedup;
+
+        if (configureFrom(spec, previous, previousCount)) return true;
+
+        memcpy(interfaces, previous, sizeof(previous));
+        interfaceCount = previousCount;
+        dedupEnabled = previousDedup;
+        return false;
+    }
+
+    string interfaceList() {
+        string names;
+        for (int i = 0; i < interfaceCount; i++) {
+            if (i > 0) names += ", ";
+            names += interfaces[i].name;
+        }
+        return names.empty() ? "none" : names;
+    }
+
+    bool dedupActive() { return dedupEnabled; }
+
+    bool setupSockets() {
+        if (epollFD >= 0) return true;
+        if (interfaceCount == 0) {
+            cout << "\n[ERROR] No capture interfaces configured\n";
+            cout << "Use option [13] to select interfaces\n";
             return false;
         }
+
+        epollFD = epoll_create1(0);
+        if (epollFD < 0) {
+            cout << "\n[ERROR] Event loop initialization failed\n";
+            return false;
+        }
+
+        for (int i = 0; i < interfaceCount; i++) {
+            CaptureInterface& iface = interfaces[i];
+            iface.fd = socket(AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, 0);
+            if (iface.fd < 0) {
+                cout << "\n[ERROR] Socket initialization failed\n";
+                cout << "Reason: Insufficient permissions for raw socket access\n";
+                closeSockets();
+                return false;
+            }
+
+            sockaddr_ll addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sll_family = AF_PACKET;
+            addr.sll_protocol = htons(ETH_P_ALL);
+            addr.sll_ifindex = iface.index;
+            epoll_event event;
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN;
+            event.data.u32 = i;
+
+            if (bind(iface.fd, (sockaddr*)&addr, sizeof(addr)) < 0 ||
+                epoll_ctl(epollFD, EPOLL_CTL_ADD, iface.fd, &event) < 0) {
+                cout << "\n[ERROR] Socket initialization failed\n";
+                cout << "Reason: Unable to bind to interface " << iface.name << "\n";
+                closeSockets();
+                return false;
+            }
+
+            int enable = 1;
+            setsockopt(iface.fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+        }
         return true;
     }
 
     void capture(int seconds) {
-        if (!setupSocket()) {
+        if (!setupSockets()) {
             return;
         }
 
         active = true;
         unsigned char buffer[65536];
+        union {
+            char buf[CMSG_SPACE(sizeof(timespec))];
+            cmsghdr align;
+        } control;
+        epoll_event events[MAX_INTERFACES];
         time_t start = time(nullptr);
+        timespec begin, end;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        lastSnapshot = start;
+        unsigned int capturedBefore = nextID;
+
+        for (int i = 0; i < interfaceCount; i++) {
+            interfaces[i].sessionPackets = 0;
+            interfaces[i].sessionBytes = 0;
+        }
         
         cout << "\n>> Initiating packet capture session\n";
         cout << ">> Duration: " << seconds << " seconds\n";
-        cout << ">> Interface: enp0s3\n";
+        cout << ">> Interfaces: " << interfaceList() << "\n";
+        cout << ">> Duplicate suppression: " << (dedupEnabled ? "on" : "off") << "\n";
         cout << ">> Press Ctrl+C to stop early\n\n";
 
         while (active && (time(nullptr) - start) < seconds) {
-            int received = recvfrom(socketFD, buffer, sizeof(buffer), 0, nullptr, nullptr);
-            
-            if (received > 0) {
-                NetworkPacket pkt(++nextID, buffer, received);
-                
-                if (received >= 34) {
-                    struct iphdr* ip = (struct iphdr*)(buffer + 14);
-                    if (ip->version == 4) {
-                        char src[INET_ADDRSTRLEN], dst[INET_ADDRSTRLEN];
-                        inet_ntop(AF_INET, &ip->saddr, src, INET_ADDRSTRLEN);
-                        inet_ntop(AF_INET, &ip->daddr, dst, INET_ADDRSTRLEN);
-                        pkt.sourceIP = src;
-                        pkt.destIP = dst;
-                    }
+            int ready = epoll_wait(epollFD, events, MAX_INTERFACES, 100);
+
+            for (int e = 0; e < ready; e++) {
+                CaptureInterface& iface = interfaces[events[e].data.u32];
+                for (int n = 0; n < CAPTURE_BATCH; n++) {
+                    sockaddr_ll from;
+                    iovec vec = { buffer, sizeof(buffer) };
+                    msghdr msg;
+                    memset(&msg, 0, sizeof(msg));
+                    msg.msg_name = &from;
+                    msg.msg_namelen = sizeof(from);
+                    msg.msg_iov = &vec;
+                    msg.msg_iovlen = 1;
+                    msg.msg_control = control.buf;
+                    msg.msg_controllen = sizeof(control.buf);
+
+                    int received = recvmsg(iface.fd, &msg, MSG_DONTWAIT);
+                    if (received <= 0) break;
+                    receiveFrame(iface, from, buffer, received, msg);
                 }
-                
-                mainQueue.add(pkt);
-                cout << "[PKT #" << pkt.identifier << "] " 
-                     << received << "B | " 
-                     << pkt.sourceIP << " → " << pkt.destIP << "\n";
             }
-            usleep(50);
+
+            reapBackgroundSnapshot(false);
+            if (time(nullptr) - lastSnapshot >= CHECKPOINT_INTERVAL) {
+                startBackgroundSnapshot();
+                lastSnapshot = time(nullptr);
+            }
         }
         
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        lastCaptureSeconds = (end.tv_sec - begin.tv_sec) + (end.tv_nsec - begin.tv_nsec) / 1e9;
+        for (int i = 0; i < interfaceCount; i++) collectDrops(interfaces[i]);
+        closeSockets();
+
+        reapBackgroundSnapshot(true);
+        startBackgroundSnapshot();
+        lastSnapshot = time(nullptr);
+
         active = false;
         cout << "\n>> Capture session terminated\n";
-        cout << ">> Total packets captured: " << nextID << "\n";
+        cout << ">> Packets captured this session: " << nextID - capturedBefore << "\n";
+        cout << ">> Total packets captured: " << nextID << "\n\n";
+        showInterfaceStats(true);
     }
 
     void showPackets() {
@@ -338,6 +1358,7 @@ public:
             total++;
             cout << "  [#" << pkt.identifier << "] ";
             cout << "Time: " << pkt.capturedAt << " | ";
+            cout << "Iface: " << interfaceName(pkt.ifIndex) << " | ";
             cout << "Route: " << pkt.sourceIP << " → " << pkt.destIP << " | ";
             cout << "Size: " << pkt.length << "B\n";
             temp.add(pkt);
@@ -358,7 +1379,7 @@ public:
 
         while (!mainQueue.empty()) {
             NetworkPacket pkt = mainQueue.remove();
-            parser.loadPacket(pkt.data, pkt.length);
+            parser.loadPacket(pkt.data.get(), pkt.length);
             analyzed++;
 
             cout << "\n  Packet #" << pkt.identifier << " Breakdown:\n";
@@ -412,9 +1433,9 @@ public:
                         continue;
                     }
                 }
-                double delay = pkt.length / 1000.0;
-                cout << "  [MATCH] Packet #" << pkt.identifier 
-                     << " | Estimated delay: " << delay << "ms\n";
+                cout << "  [MATCH] Packet #" << pkt.identifier << " | RTT: ";
+                if (pkt.rttUs >= 0) cout << pkt.rttUs / 1000.0 << "ms\n";
+                else cout << "n/a\n";
                 matchedQueue.add(pkt);
                 matched++;
             } else {
@@ -438,9 +1459,9 @@ public:
         while (!matchedQueue.empty()) {
             NetworkPacket pkt = matchedQueue.remove();
             count++;
-            double delay = pkt.length / 1000.0;
             cout << "  [#" << pkt.identifier << "] ";
-            cout << "Delay: " << delay << "ms | ";
+            if (pkt.rttUs >= 0) cout << "RTT: " << pkt.rttUs / 1000.0 << "ms | ";
+            else cout << "RTT: n/a | ";
             cout << pkt.sourceIP << " ↔ " << pkt.destIP << "\n";
             temp.add(pkt);
         }
@@ -525,7 +1546,77 @@ public:
         cout << "  Main Queue ............... " << mainQueue.size() << " packets\n";
         cout << "  Filtered Queue ........... " << matchedQueue.size() << " packets\n";
         cout << "  Retry Queue .............. " << retryQueue.size() << " packets\n";
-        cout << "  Total Packets Captured ... " << nextID << "\n\n";
+        cout << "  Total Packets Captured ... " << nextID << "\n";
+        cout << "  Tracked TCP Flows ........ " << latency.activeFlows() << "\n";
+        cout << "  RTT Samples .............. " << latency.sampleCount() << "\n\n";
+        showInterfaceStats(false);
+    }
+
+    void latencyReport() {
+        cout << "\n";
+        cout << "┌────────────────────────────────────────────────────────────────┐\n";
+        cout << "│                  TCP LATENCY REPORT                            │\n";
+        cout << "└────────────────────────────────────────────────────────────────┘\n\n";
+        latency.report(10);
+    }
+
+    void saveCheckpoint() {
+        cout << "\n";
+        cout << "┌────────────────────────────────────────────────────────────────┐\n";
+        cout << "│                    CHECKPOINT SAVE                             │\n";
+        cout << "└────────────────────────────────────────────────────────────────┘\n\n";
+
+        reapBackgroundSnapshot(true);
+        timespec begin, end;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        bool ok = writeCheckpoint();
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if (!ok) {
+            cout << "[ERROR] Checkpoint write failed\n";
+            cout << "Reason: Unable to write " << CHECKPOINT_PATH << "\n";
+            return;
+        }
+        double elapsed = (end.tv_sec - begin.tv_sec) * 1000.0 + (end.tv_nsec - begin.tv_nsec) / 1e6;
+        cout << "  File ..................... " << CHECKPOINT_PATH << "\n";
+        cout << "  Packets Saved ............ "
+             << mainQueue.size() + matchedQueue.size() + retryQueue.size() << "\n";
+        cout << "  Elapsed .................. " << elapsed << "ms\n";
+    }
+
+    bool restoreCheckpoint() {
+        cout << "\n";
+        cout << "┌────────────────────────────────────────────────────────────────┐\n";
+        cout << "│                    CHECKPOINT RESTORE                          │\n";
+        cout << "└────────────────────────────────────────────────────────────────┘\n\n";
+
+        reapBackgroundSnapshot(true);
+        CustomQueue<NetworkPacket>* queues[3] = { &mainQueue, &matchedQueue, &retryQueue };
+        timespec begin, end;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        bool ok = CheckpointStore::load(CHECKPOINT_PATH, nextID, queues);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if (!ok) {
+            cout << "[ERROR] Checkpoint restore failed\n";
+            if (access(CHECKPOINT_PATH, F_OK) != 0) {
+                cout << "Reason: " << CHECKPOINT_PATH << " does not exist\n";
+                return false;
+            }
+            cout << "Reason: " << CHECKPOINT_PATH << " is truncated or from another version\n";
+            string keptPath = string(CHECKPOINT_PATH) + ".rejected";
+            if (rename(CHECKPOINT_PATH, keptPath.c_str()) == 0) {
+                cout << ">> Rejected file kept as " << keptPath << " so later saves do not overwrite it\n";
+            }
+            return false;
+        }
+        double elapsed = (end.tv_sec - begin.tv_sec) * 1000.0 + (end.tv_nsec - begin.tv_nsec) / 1e6;
+        cout << "  Main Queue ............... " << mainQueue.size() << " packets\n";
+        cout << "  Filtered Queue ........... " << matchedQueue.size() << " packets\n";
+        cout << "  Retry Queue .............. " << retryQueue.size() << " packets\n";
+        cout << "  Next Packet ID ........... " << nextID + 1 << "\n";
+        cout << "  Elapsed .................. " << elapsed << "ms\n";
+        return true;
     }
 
     int getMainCount() { return mainQueue.size(); }
@@ -545,12 +1636,16 @@ void printMenu() {
     cout << "  [7] Check Retry Queue\n";
     cout << "  [8] Display System Statistics\n";
     cout << "  [9] Run Complete Test Suite\n";
+    cout << "  [10] Save State Checkpoint\n";
+    cout << "  [11] Restore State Checkpoint\n";
+    cout << "  [12] TCP Latency Report\n";
+    cout << "  [13] Configure Capture Interfaces\n";
     cout << "  [0] Exit Program\n";
     cout << "\n══════════════════════════════════════════════════════════════════\n";
     cout << "  Select option: ";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     if (geteuid() != 0) {
         cout << "\n══════════════════════════════════════════════════════════════════\n";
         cout << "                    ACCESS DENIED                                 \n";
@@ -561,19 +1656,39 @@ int main() {
         return 1;
     }
 
+    PacketMonitor monitor;
+    string interfaceSpec;
+    bool dedup = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dedup") == 0) {
+            dedup = true;
+        } else {
+            if (!interfaceSpec.empty()) interfaceSpec += ",";
+            interfaceSpec += argv[i];
+        }
+    }
+    if (!monitor.configureInterfaces(interfaceSpec.empty() ? "all" : interfaceSpec, dedup)) {
+        cout << "\n  Usage: sudo ./network_monitor [--dedup] [interface ...]\n\n";
+        return 1;
+    }
+
     cout << "══════════════════════════════════════════════════════════════════\n";
     cout << "          NETWORK PACKET MONITORING SYSTEM                        \n";
     cout << "══════════════════════════════════════════════════════════════════\n";
     cout << "\n  >> Root access verified successfully\n\n";
     cout << "  System Configuration:\n";
     cout << "  ├─ Operating System: Linux\n";
-    cout << "  ├─ Network Interface: enp0s3\n";
+    cout << "  ├─ Capture Interfaces: " << monitor.interfaceList() << "\n";
+    cout << "  ├─ Duplicate Suppression: " << (monitor.dedupActive() ? "on" : "off") << "\n";
     cout << "  ├─ Packet Size Limit: 1500 bytes\n";
     cout << "  ├─ Oversized Threshold: 10 packets\n";
     cout << "  └─ Maximum Retry Attempts: 2 per packet\n";
     cout << "══════════════════════════════════════════════════════════════════\n";
 
-    PacketMonitor monitor;
+    if (access(CHECKPOINT_PATH, F_OK) == 0) {
+        cout << "\n>> Found checkpoint " << CHECKPOINT_PATH << ", restoring previous session\n";
+        monitor.restoreCheckpoint();
+    }
 
     while (true) {
         printMenu();
@@ -584,6 +1699,7 @@ int main() {
         switch (choice) {
             case 0:
                 cout << "\n>> Shutting down monitoring system...\n";
+                monitor.saveCheckpoint();
                 cout << ">> Thank you for using the packet monitor\n\n";
                 return 0;
 
@@ -700,15 +1816,52 @@ int main() {
                 } else {
                     cout << "\n[WARNING] No packets captured during test\n";
                     cout << "Possible issues:\n";
-                    cout << "  • Network interface (enp0s3) may not exist\n";
-                    cout << "  • No active network traffic on interface\n";
+                    cout << "  • Configured interfaces (" << monitor.interfaceList() << ") may be down\n";
+                    cout << "  • No active network traffic on the selected interfaces\n";
                     cout << "  • Insufficient capture duration\n";
                 }
                 break;
 
+            case 10:
+                cout << "\n[OPERATION] Save State Checkpoint";
+                cout << "\n" << string(66, '-') << "\n";
+                monitor.saveCheckpoint();
+                break;
+
+            case 11:
+                cout << "\n[OPERATION] Restore State Checkpoint";
+                cout << "\n" << string(66, '-') << "\n";
+                monitor.restoreCheckpoint();
+                break;
+
+            case 12:
+                cout << "\n[OPERATION] TCP Latency Report";
+                cout << "\n" << string(66, '-') << "\n";
+                monitor.latencyReport();
+                break;
+
+            case 13: {
+                cout << "\n[OPERATION] Configure Capture Interfaces";
+                cout << "\n" << string(66, '-') << "\n";
+                cout << "\nCurrent interfaces: " << monitor.interfaceList() << "\n";
+                cout << "Enter interfaces (comma-separated, or 'all'): ";
+                string spec;
+                cin >> spec;
+                cout << "Suppress duplicate frames across interfaces? (y/n): ";
+                string answer;
+                cin >> answer;
+                if (monitor.configureInterfaces(spec, answer == "y" || answer == "Y")) {
+                    cout << "\n>> Capturing on: " << monitor.interfaceList() << "\n";
+                    cout << ">> Duplicate suppression: " << (monitor.dedupActive() ? "on" : "off") << "\n";
+                } else {
+                    cout << ">> Keeping previous interfaces: " << monitor.interfaceList() << "\n";
+                }
+                break;
+            }
+
             default:
                 cout << "\n[ERROR] Invalid selection\n";
-                cout << "Please choose an option between [0-9]\n";
+                cout << "Please choose an option between [0-13]\n";
         }
     }
 